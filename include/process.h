@@ -3,6 +3,9 @@
 #define PROCESS_H
 #define MAX_INSTR 20
 #define MAX_REPEATED_JUMPS 2
+#define MAX_PROCESSES 100
+#define MAX_CPUS 32            // Width of the affinity bitmask
+#define AFFINITY_ALL (~0u)     // Default affinity: may run on any CPU
 
 /*
     * Struct: process_t
@@ -19,6 +22,10 @@
     *   repeated_jumps    - Counter for how many times the same jump has been repeated consecutively.
     *   num_instructions  - Total number of instructions loaded into the process.
     *   instructions      - Array holding the process's instructions as strings.
+    *   affinity          - Bitmask of CPUs the process may run on (bit n = CPU n).
+    *   cpu               - CPU whose run queue currently owns the process (SMP mode).
+    *   migrations        - Number of times the process has been moved to another CPU.
+    *   migration_stall   - Ticks left to pay as migration penalty before it executes again.
 */
 typedef struct {
     int pid;
@@ -31,6 +38,11 @@ typedef struct {
     int repeated_jumps;     // How many times we jumped to the same line in a row
     int num_instructions;   // Loaded instruction count
     char instructions[MAX_INSTR][20]; // Fixed-size array of instruction strings
+
+    unsigned int affinity;  // Allowed CPUs bitmask (SMP mode)
+    int cpu;                // Owning CPU (SMP mode)
+    int migrations;         // Times moved between CPUs
+    int migration_stall;    // Pending migration penalty ticks
 } process_t;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef SMP_H
+#define SMP_H
+#include "process.h"
+
+#define DEFAULT_MIGRATION_COST 2    // Ticks a migrated process stalls before executing
+#define DEFAULT_BALANCE_INTERVAL 4  // Ticks between load balancing passes
+
+/*
+    * Struct: smp_config_t
+    * -----------------------------------------------------------------------------------
+    * Parameters of the simulated multiprocessor.
+    * -----------------------------------------------------------------------------------
+    * Members:
+    *   num_cpus          - Number of virtual CPUs (1..MAX_CPUS), each with its own run queue.
+    *   migration_cost    - Ticks a process stalls on its new CPU after being migrated.
+    *   balance_interval  - Every how many ticks the load balancer runs.
+*/
+typedef struct {
+    int num_cpus;
+    int migration_cost;
+    int balance_interval;
+} smp_config_t;
+
+/*
+    * Function: run_round_robin_smp
+    * See src/smp.c for detailed documentation.
+*/
+void run_round_robin_smp(process_t processes[], int num_processes, const smp_config_t* config);
+
+#endif
@@ -27,10 +27,13 @@
     *   - Reads the file line-by-line, parsing each process definition until either
     *     EOF is reached or max_processes is met.
     *   - Initializes each process_t structure with default values:
-    *       * PID set to -1, registers and counters reset, status set to "Ready".
+    *       * PID set to -1, registers and counters reset, status set to "Ready",
+    *         affinity set to all CPUs.
     *   - Parses tokens in the format:
     *       * "PID:<number>"      → sets the process ID.
     *       * "Quantum=<number>"  → sets the time quantum for scheduling.
+    *       * "Affinity=<mask>"   → restricts the CPUs the process may run on
+    *                               (decimal or 0x-prefixed hex bitmask, bit n = CPU n).
     *       * "<REG>=<number>"    → assigns values to registers AX, BX, CX.
     *   - If a valid PID is found, attempts to open a corresponding instruction file
     *     named "<PID>.txt". If found, reads instructions into the process's instruction list.
@@ -67,6 +70,10 @@ int load_processes(const char* filename, process_t processes[], int max_processe
         p->num_instructions = 0;
         p->last_jump = -1;
         p->repeated_jumps = 0;
+        p->affinity = AFFINITY_ALL;
+        p->cpu = 0;
+        p->migrations = 0;
+        p->migration_stall = 0;
 
         line[strcspn(line, "\n")] = 0;
 
@@ -81,9 +88,13 @@ int load_processes(const char* filename, process_t processes[], int max_processe
             
             char reg_name[3];
             int value;
+            unsigned int mask;
 
             if (sscanf(token, "PID:%d", &p->pid) == 1) { // PID
             } else if (sscanf(token, "Quantum=%d", &p->quantum) == 1) { // Quantum
+            } else if (sscanf(token, "Affinity=0x%x", &mask) == 1 ||
+                       sscanf(token, "Affinity=%u", &mask) == 1) { // CPU affinity mask (hex or decimal)
+                p->affinity = mask;
             } else if (sscanf(token, "%2s=%d", reg_name, &value) == 2) { // Register
                 if (strcmp(reg_name, "AX") == 0) p->ax = value;
                 else if (strcmp(reg_name, "BX") == 0) p->bx = value;
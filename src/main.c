@@ -4,10 +4,38 @@
 #include "process.h"
 #include "loader.h"
 #include "planner.h"
+#include "smp.h"
 #include "utils/logger.h"
 #include "utils/colors.h"
 
-#define MAX_PROCESSES 100
+#define USAGE "Usage: procplanner -f processes_file [--cpus N] [--migration-cost T] [--balance-interval T]"
+
+/*
+    * Function: parse_int_option
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Parses the integer value of a command-line option and checks that it lies within a range.
+    * -----------------------------------------------------------------------------------
+    * Parameters:
+    *   name  - Option name, used in the error message.
+    *   text  - Option value as given on the command line.
+    *   min   - Smallest accepted value.
+    *   max   - Largest accepted value.
+    *   out   - Where to store the parsed value.
+    * -----------------------------------------------------------------------------------
+    * Returns:
+    *   1 if the value is a valid integer within [min, max], 0 otherwise.
+*/
+static int parse_int_option(const char* name, const char* text, int min, int max, int* out) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || value < min || value > max) {
+        fprintf(stderr, COLOR_ERROR "Invalid value '%s' for %s (expected %d..%d)" COLOR_RESET "\n", text, name, min, max);
+        return 0;
+    }
+    *out = (int)value;
+    return 1;
+}
 
 /*
     * Function: main
@@ -15,13 +43,18 @@
     * Purpose:
     *   Entry point for the process planner simulation program.
     *   Reads a process description file, loads the processes into memory,
-    *   logs their details, and runs the Round-Robin scheduling simulation.
+    *   logs their details, and runs the Round-Robin scheduling simulation on one
+    *   CPU or, when requested, on several virtual CPUs.
     * -----------------------------------------------------------------------------------
     * Parameters:
     *   argc - Number of command-line arguments.
     *   argv - Array of command-line arguments:
     *          argv[1] should be "-f"
     *          argv[2] should be the path to the processes file.
+    *          Optional pairs that may follow:
+    *            --cpus N               number of virtual CPUs (default 1).
+    *            --migration-cost T     stall ticks after a migration (default 2).
+    *            --balance-interval T   ticks between load balancing passes (default 4).
     * -----------------------------------------------------------------------------------
     * Returns:
     *   EXIT_SUCCESS on successful execution.
@@ -29,28 +62,49 @@
     * -----------------------------------------------------------------------------------
     * Behavior:
     *   - Validates the number of command-line arguments.
-    *   - Checks that the flag "-f" is provided.
+    *   - Checks that the flag "-f" is provided and parses the optional SMP flags.
     *   - Initializes the logger to record simulation output.
     *   - Loads processes from the specified file using load_processes().
     *   - Prints and logs process details to both console and log file.
-    *   - Executes the Round-Robin scheduler with run_round_robin().
+    *   - Executes the Round-Robin scheduler with run_round_robin(), or with
+    *     run_round_robin_smp() when more than one CPU is requested.
     *   - Closes the logger before exiting.
 */
 int main(int argc, char *argv[]) {
     // Validate the number of arguments
-    if (argc != 3) {
+    if (argc < 3 || argc % 2 == 0) {
         fprintf(stderr, COLOR_ERROR "Invalid number of arguments." COLOR_RESET "\n");
-        fprintf(stderr, COLOR_INFO "Usage: procplanner -f processes_file" COLOR_RESET "\n");
+        fprintf(stderr, COLOR_INFO USAGE COLOR_RESET "\n");
         return EXIT_FAILURE;
     }
 
     // Validate that the correct flag "-f" is provided
     if (strcmp(argv[1], "-f") != 0) {
         fprintf(stderr, COLOR_ERROR "Invalid flag. Expected -f" COLOR_RESET "\n");
-        fprintf(stderr, COLOR_INFO "Usage: procplanner -f processes_file" COLOR_RESET);
+        fprintf(stderr, COLOR_INFO USAGE COLOR_RESET);
         return EXIT_FAILURE;
     }
 
+    // Parse the optional SMP flags
+    smp_config_t smp = { 1, DEFAULT_MIGRATION_COST, DEFAULT_BALANCE_INTERVAL };
+    for (int i = 3; i < argc; i += 2) {
+        int ok;
+        if (strcmp(argv[i], "--cpus") == 0) {
+            ok = parse_int_option(argv[i], argv[i + 1], 1, MAX_CPUS, &smp.num_cpus);
+        } else if (strcmp(argv[i], "--migration-cost") == 0) {
+            ok = parse_int_option(argv[i], argv[i + 1], 0, 1000, &smp.migration_cost);
+        } else if (strcmp(argv[i], "--balance-interval") == 0) {
+            ok = parse_int_option(argv[i], argv[i + 1], 1, 1000, &smp.balance_interval);
+        } else {
+            fprintf(stderr, COLOR_ERROR "Unknown option '%s'" COLOR_RESET "\n", argv[i]);
+            ok = 0;
+        }
+        if (!ok) {
+            fprintf(stderr, COLOR_INFO USAGE COLOR_RESET "\n");
+            return EXIT_FAILURE;
+        }
+    }
+
     // Initialize the logger
     init_logger("logs.log");
     log_info("Starting simulation with input file: %s", argv[2]);
@@ -74,8 +128,12 @@ int main(int argc, char *argv[]) {
                 processes[i].quantum, processes[i].num_instructions);
     }
 
-    // Execute the Round-Robin scheduling algorithm
-    run_round_robin(processes, num_processes);
+    // Execute the Round-Robin scheduling algorithm on one or several CPUs
+    if (smp.num_cpus > 1) {
+        run_round_robin_smp(processes, num_processes, &smp);
+    } else {
+        run_round_robin(processes, num_processes);
+    }
 
     // Close the logger before program termination
     close_logger();
@@ -0,0 +1,357 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "smp.h"
+#include "planner.h"
+#include "utils/logger.h"
+#include "utils/colors.h"
+
+/*
+    * Struct: cpu_t
+    * -----------------------------------------------------------------------------------
+    * State of one virtual CPU in the SMP simulation.
+    * -----------------------------------------------------------------------------------
+    * Members:
+    *   queue            - Circular FIFO run queue holding indices into the process array.
+    *   head, count      - Position of the first queued element and number of queued processes.
+    *   current          - Index of the process running on the CPU, or -1 if idle.
+    *   slice_used       - Instructions the current process has executed in this time slice.
+    *   busy_ticks       - Ticks spent executing instructions.
+    *   stall_ticks      - Ticks lost paying migration penalties.
+    *   idle_ticks       - Ticks with nothing to run.
+    *   context_switches - Number of times a process was dispatched on this CPU.
+    *   migrations_in    - Processes pulled into this CPU by the load balancer.
+    *   migrations_out   - Processes pulled away from this CPU by the load balancer.
+*/
+typedef struct {
+    int queue[MAX_PROCESSES];
+    int head, count;
+    int current;
+    int slice_used;
+
+    int busy_ticks;
+    int stall_ticks;
+    int idle_ticks;
+    int context_switches;
+    int migrations_in;
+    int migrations_out;
+} cpu_t;
+
+// Enqueue a process index at the tail of the CPU's run queue
+static void rq_push(cpu_t* cpu, int idx) {
+    cpu->queue[(cpu->head + cpu->count) % MAX_PROCESSES] = idx;
+    cpu->count++;
+}
+
+// Dequeue the process index at the head of the CPU's run queue
+static int rq_pop(cpu_t* cpu) {
+    int idx = cpu->queue[cpu->head];
+    cpu->head = (cpu->head + 1) % MAX_PROCESSES;
+    cpu->count--;
+    return idx;
+}
+
+// Remove the element at logical position pos (0 = head), keeping FIFO order of the rest
+static int rq_remove_at(cpu_t* cpu, int pos) {
+    int idx = cpu->queue[(cpu->head + pos) % MAX_PROCESSES];
+    for (int i = pos; i < cpu->count - 1; i++) {
+        cpu->queue[(cpu->head + i) % MAX_PROCESSES] = cpu->queue[(cpu->head + i + 1) % MAX_PROCESSES];
+    }
+    cpu->count--;
+    return idx;
+}
+
+// Load of a CPU: queued processes plus the one running on it
+static int cpu_load(const cpu_t* cpu) {
+    return cpu->count + (cpu->current >= 0 ? 1 : 0);
+}
+
+/*
+    * Function: find_movable
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Looks for a queued process on src that is allowed to run on CPU dst.
+    * -----------------------------------------------------------------------------------
+    * Returns:
+    *   Logical position of the candidate in src's run queue, or -1 if none qualifies.
+    * -----------------------------------------------------------------------------------
+    * Behavior:
+    *   - Scans from the tail: the most recently enqueued process has waited the least
+    *     and is the cheapest to move, while the head is about to run on src anyway.
+    *   - The running process is never migrated.
+*/
+static int find_movable(const cpu_t* src, int dst, const process_t processes[]) {
+    for (int pos = src->count - 1; pos >= 0; pos--) {
+        int idx = src->queue[(src->head + pos) % MAX_PROCESSES];
+        if (processes[idx].affinity & (1u << dst)) return pos;
+    }
+    return -1;
+}
+
+/*
+    * Function: load_balance
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Evens out run queue lengths by migrating queued processes between CPUs.
+    * -----------------------------------------------------------------------------------
+    * Parameters:
+    *   cpus      - Array of virtual CPUs.
+    *   processes - Array of process structures.
+    *   config    - SMP configuration (number of CPUs and migration cost).
+    *   tick      - Current simulation tick (for reporting).
+    * -----------------------------------------------------------------------------------
+    * Behavior:
+    *   - Repeatedly picks the (busiest, idlest) CPU pair with the largest load difference
+    *     greater than one for which a queued process on the busiest CPU may run on the
+    *     idlest one according to its affinity mask.
+    *   - Moves that process, charges it migration_cost stall ticks and counts the
+    *     migration on both CPUs and on the process.
+    *   - Stops when no pair is imbalanced by more than one movable process.
+*/
+static void load_balance(cpu_t cpus[], process_t processes[], const smp_config_t* config, int tick) {
+    while (true) {
+        int best_src = -1, best_dst = -1, best_pos = -1, best_gap = 1;
+
+        for (int src = 0; src < config->num_cpus; src++) {
+            for (int dst = 0; dst < config->num_cpus; dst++) {
+                int gap = cpu_load(&cpus[src]) - cpu_load(&cpus[dst]);
+                if (gap <= best_gap) continue;
+
+                int pos = find_movable(&cpus[src], dst, processes);
+                if (pos < 0) continue;
+
+                best_src = src;
+                best_dst = dst;
+                best_pos = pos;
+                best_gap = gap;
+            }
+        }
+
+        if (best_src < 0) break; // balanced as far as affinities allow
+
+        int idx = rq_remove_at(&cpus[best_src], best_pos);
+        process_t* p = &processes[idx];
+        rq_push(&cpus[best_dst], idx);
+        p->cpu = best_dst;
+        p->migrations++;
+        p->migration_stall = config->migration_cost;
+        cpus[best_src].migrations_out++;
+        cpus[best_dst].migrations_in++;
+
+        printf(COLOR_HIGHLIGHT "[t=%d] [Load balance] PID %d migrated CPU %d -> CPU %d" COLOR_RESET "\n",
+               tick, p->pid, best_src, best_dst);
+        log_info("Tick %d: load balance migrated PID %d from CPU %d to CPU %d",
+                 tick, p->pid, best_src, best_dst);
+    }
+}
+
+/*
+    * Function: finish_or_requeue
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Takes the current process off a CPU once it finished, was killed or used up
+    *   its quantum, and puts it back on the CPU's run queue if it still has work.
+    * -----------------------------------------------------------------------------------
+    * Returns:
+    *   true if the process finished, false otherwise.
+*/
+static bool finish_or_requeue(cpu_t* cpu, int cpu_id, process_t processes[], int tick) {
+    int idx = cpu->current;
+    process_t* p = &processes[idx];
+
+    printf(COLOR_INFO "[t=%d] [CPU %d] Updated state: " COLOR_RESET COLOR_PROCESS "PID=%d " COLOR_RESET
+           COLOR_REGISTER "PC=%d AX=%d BX=%d CX=%d" COLOR_RESET "\n",
+           tick, cpu_id, p->pid, p->pc, p->ax, p->bx, p->cx);
+    log_info("CPU %d: process %d updated status: PC=%d, AX=%d, BX=%d, CX=%d",
+             cpu_id, p->pid, p->pc, p->ax, p->bx, p->cx);
+
+    cpu->current = -1;
+
+    if (p->pc >= p->num_instructions || p->repeated_jumps > MAX_REPEATED_JUMPS) { // done or killed
+        strcpy(p->status, "Finished");
+        printf(COLOR_SUCCESS "[t=%d] [CPU %d]   -> Process %d finished" COLOR_RESET "\n", tick, cpu_id, p->pid);
+        log_info("CPU %d: process %d finished execution", cpu_id, p->pid);
+        return true;
+    }
+
+    strcpy(p->status, "Ready"); // back to the tail of its own run queue
+    rq_push(cpu, idx);
+    log_info("CPU %d: process %d set to Ready", cpu_id, p->pid);
+    return false;
+}
+
+/*
+    * Function: print_smp_report
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Prints and logs per-CPU utilization and migration statistics, plus the
+    *   number of migrations suffered by each process.
+*/
+static void print_smp_report(const cpu_t cpus[], const process_t processes[], int num_processes,
+                             const smp_config_t* config, int total_ticks) {
+    int total_migrations = 0;
+
+    printf(COLOR_BOLD "\n[SMP report] %d CPUs, %d ticks, migration cost %d, balance interval %d" COLOR_RESET "\n",
+           config->num_cpus, total_ticks, config->migration_cost, config->balance_interval);
+    log_info("SMP report: %d CPUs, %d ticks, migration cost %d, balance interval %d",
+             config->num_cpus, total_ticks, config->migration_cost, config->balance_interval);
+
+    for (int c = 0; c < config->num_cpus; c++) {
+        const cpu_t* cpu = &cpus[c];
+        double utilization = total_ticks > 0 ? 100.0 * cpu->busy_ticks / total_ticks : 0.0;
+
+        printf(COLOR_INFO "CPU %d" COLOR_RESET " | Utilization: %5.1f%% | Busy: %d | Stall: %d | Idle: %d"
+               " | Switches: %d | Migrations in: %d | out: %d\n",
+               c, utilization, cpu->busy_ticks, cpu->stall_ticks, cpu->idle_ticks,
+               cpu->context_switches, cpu->migrations_in, cpu->migrations_out);
+        log_info("CPU %d: utilization %.1f%%, busy %d, stall %d, idle %d, switches %d, migrations in %d, out %d",
+                 c, utilization, cpu->busy_ticks, cpu->stall_ticks, cpu->idle_ticks,
+                 cpu->context_switches, cpu->migrations_in, cpu->migrations_out);
+        total_migrations += cpu->migrations_in;
+    }
+
+    for (int i = 0; i < num_processes; i++) {
+        printf(COLOR_PROCESS "PID %d" COLOR_RESET " | Final CPU: %d | Migrations: %d\n",
+               processes[i].pid, processes[i].cpu, processes[i].migrations);
+        log_info("PID %d: final CPU %d, migrations %d",
+                 processes[i].pid, processes[i].cpu, processes[i].migrations);
+    }
+
+    printf(COLOR_HIGHLIGHT "Total migrations: %d" COLOR_RESET "\n", total_migrations);
+    log_info("Total migrations: %d", total_migrations);
+}
+
+/*
+    * Function: run_round_robin_smp
+    * -----------------------------------------------------------------------------------
+    * Purpose:
+    *   Simulates Round-Robin scheduling on several virtual CPUs, each with its own
+    *   run queue, with periodic load balancing between them.
+    * -----------------------------------------------------------------------------------
+    * Parameters:
+    *   processes     - Array of process structures.
+    *   num_processes - Number of processes in the array.
+    *   config        - SMP configuration (CPUs, migration cost, balance interval).
+    * -----------------------------------------------------------------------------------
+    * Behavior:
+    *   - Time advances in ticks; every CPU executes at most one instruction per tick.
+    *   - Affinity masks are clipped to the configured CPUs; a process whose mask
+    *     selects none of them may run anywhere (a warning is printed).
+    *   - Each process is initially placed on the least loaded CPU it may run on.
+    *   - An idle CPU dispatches the head of its run queue, which then runs for up to
+    *     its quantum before going back to the tail of the same queue.
+    *   - A migrated process first stalls for migration_cost ticks on its new CPU
+    *     (modelling a cold cache); the stall does not consume its quantum.
+    *   - Every balance_interval ticks load_balance() migrates queued processes.
+    *   - Repeated-jump detection terminates looping processes as in run_round_robin().
+    *   - Prints per-CPU utilization and migration counts when all processes finish.
+    * -----------------------------------------------------------------------------------
+    * Usage:
+    *   Called instead of run_round_robin() when more than one CPU is requested.
+*/
+void run_round_robin_smp(process_t processes[], int num_processes, const smp_config_t* config) {
+    cpu_t cpus[MAX_CPUS];
+    unsigned int all_cpus = config->num_cpus >= MAX_CPUS ? AFFINITY_ALL : (1u << config->num_cpus) - 1;
+    int finished = 0;
+    int tick = 0;
+
+    memset(cpus, 0, sizeof(cpus));
+    for (int c = 0; c < config->num_cpus; c++) cpus[c].current = -1;
+
+    log_info("Starting SMP simulation with %d CPUs", config->num_cpus);
+
+    // Initial placement: least loaded allowed CPU, lowest index on ties
+    for (int i = 0; i < num_processes; i++) {
+        process_t* p = &processes[i];
+
+        p->affinity &= all_cpus;
+        if (p->affinity == 0) {
+            printf(COLOR_WARNING "Warning: Affinity of PID %d selects no available CPU, allowing all." COLOR_RESET "\n", p->pid);
+            log_error("Affinity of PID %d selects no available CPU, allowing all", p->pid);
+            p->affinity = all_cpus;
+        }
+
+        int target = -1;
+        for (int c = 0; c < config->num_cpus; c++) {
+            if (!(p->affinity & (1u << c))) continue;
+            if (target < 0 || cpus[c].count < cpus[target].count) target = c;
+        }
+
+        p->cpu = target;
+        p->migrations = 0;
+        p->migration_stall = 0;
+        rq_push(&cpus[target], i);
+        printf(COLOR_INFO "PID %d placed on CPU %d (affinity 0x%x)" COLOR_RESET "\n", p->pid, target, p->affinity);
+        log_info("PID %d placed on CPU %d (affinity 0x%x)", p->pid, target, p->affinity);
+    }
+
+    while (finished < num_processes) {
+        for (int c = 0; c < config->num_cpus; c++) {
+            cpu_t* cpu = &cpus[c];
+
+            // Dispatch the next runnable process; empty programs finish without using a tick
+            while (cpu->current < 0 && cpu->count > 0) {
+                int idx = rq_pop(cpu);
+                process_t* p = &processes[idx];
+
+                cpu->current = idx;
+                cpu->slice_used = 0;
+                cpu->context_switches++;
+                strcpy(p->status, "Executing");
+
+                printf(COLOR_CONTEXT "\n[t=%d] [CPU %d] [Context switch] -> Next PID %d" COLOR_RESET "\n", tick, c, p->pid);
+                log_info("Tick %d: CPU %d context switch to PID %d", tick, c, p->pid);
+                printf(COLOR_INFO "[t=%d] [CPU %d] Saving state: " COLOR_RESET COLOR_PROCESS "PID=%d " COLOR_RESET
+                       COLOR_REGISTER "PC=%d AX=%d BX=%d CX=%d" COLOR_RESET "\n",
+                       tick, c, p->pid, p->pc, p->ax, p->bx, p->cx);
+
+                if (p->pc >= p->num_instructions) {
+                    p->migration_stall = 0;
+                    if (finish_or_requeue(cpu, c, processes, tick)) finished++;
+                }
+            }
+
+            if (cpu->current < 0) { // nothing to run on this CPU
+                cpu->idle_ticks++;
+                continue;
+            }
+
+            process_t* p = &processes[cpu->current];
+
+            if (p->migration_stall > 0) { // cold cache after migration
+                p->migration_stall--;
+                cpu->stall_ticks++;
+                printf(COLOR_DIM "  [t=%d] [CPU %d] PID %d migration stall (%d left)" COLOR_RESET "\n",
+                       tick, c, p->pid, p->migration_stall);
+                continue;
+            }
+
+            printf(COLOR_INSTRUCTION "  [t=%d] [CPU %d] [%d] %s" COLOR_RESET "\n", tick, c, p->pc, p->instructions[p->pc]);
+            exec_instruction(p, p->instructions[p->pc]);
+            p->pc++;
+            cpu->slice_used++;
+            cpu->busy_ticks++;
+
+            if (p->repeated_jumps > MAX_REPEATED_JUMPS) {
+                printf(COLOR_ERROR "Process %d has exceeded the maximum number of repeated jumps (%d). Terminating process..." COLOR_RESET "\n", p->pid, MAX_REPEATED_JUMPS);
+                log_error("Process %d exceeded max repeated jumps. Terminating process", p->pid);
+            }
+
+            // A non-positive quantum still gets one instruction per slice so the simulation progresses
+            if (p->pc >= p->num_instructions || p->repeated_jumps > MAX_REPEATED_JUMPS ||
+                cpu->slice_used >= (p->quantum > 0 ? p->quantum : 1)) {
+                if (finish_or_requeue(cpu, c, processes, tick)) finished++;
+            }
+        }
+
+        tick++;
+        if (finished < num_processes && tick % config->balance_interval == 0) {
+            load_balance(cpus, processes, config, tick);
+        }
+    }
+
+    printf(COLOR_SUCCESS COLOR_BOLD "\n[End of simulation] All processes have finished." COLOR_RESET "\n");
+    log_info("End of simulation: All processes have finished execution");
+
+    print_smp_report(cpus, processes, num_processes, config, tick);
+}